@@ -1,16 +1,26 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 
+enum class TimeInForce {
+    GTC, // good till cancel
+    GTD, // good till expireTime
+    DAY  // cancelled at session end, expires at expireTime if one is set
+};
+
 struct Order {
     std::string id;
     std::string symbol;
     double price;
     double qty;
     bool isBuy; // true -> buy, false -> sell
+    TimeInForce timeInForce = TimeInForce::GTC;
+    int64_t expireTime = 0; // ms since epoch, 0 -> no expiry
 
     Order() = default;
     Order(const std::string& orderId, const std::string& orderSymbol, double orderPrice, double orderQty,
-          bool orderIsBuy)
-        : id(orderId), symbol(orderSymbol), price(orderPrice), qty(orderQty), isBuy(orderIsBuy) {}
+          bool orderIsBuy, TimeInForce orderTimeInForce = TimeInForce::GTC, int64_t orderExpireTime = 0)
+        : id(orderId), symbol(orderSymbol), price(orderPrice), qty(orderQty), isBuy(orderIsBuy),
+          timeInForce(orderTimeInForce), expireTime(orderExpireTime) {}
 };
@@ -3,20 +3,35 @@
 #include <map>
 #include <shared_mutex>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "order.hpp"
+#include "timing_wheel.hpp"
 
 class OrderBook {
   public:
+    // expiry wheel starts at the current wall-clock time
+    OrderBook();
+
+    OrderBook(int64_t startTimeMs, int64_t expiryTickMs = 1);
+
     void matchOrders(const std::string& symbol);
 
+    // GTD/DAY orders with an expireTime are scheduled for expiry, a GTD order without one is rejected with
+    // std::invalid_argument. An order with an existing id replaces the resting one and loses its time priority.
     void addOrder(const Order& order);
 
     bool cancelOrder(const std::string& orderId);
 
     bool modifyOrderQuantity(const std::string& orderId, size_t newQuantity);
 
+    // removes every order whose expireTime is at or before nowMs in one batch, returns the number removed
+    size_t expireOrders(int64_t nowMs, std::vector<std::string>* expiredOrderIds = nullptr);
+
+    // session end: removes every resting DAY order in one batch, returns the number removed
+    size_t cancelDayOrders(std::vector<std::string>* cancelledOrderIds = nullptr);
+
     std::vector<Order> getOrdersForSymbol(const std::string& symbol, bool isBuy) const;
 
     std::pair<double, double> getBestPrices(const std::string& symbol) const;
@@ -24,12 +39,31 @@ class OrderBook {
     size_t getTotalOrderVolume(const std::string& symbol, bool isBuy) const;
 
   private:
+    using BuyOrders = std::multimap<double, Order, std::greater<double>>;
+    using SellOrders = std::multimap<double, Order>;
+
     struct OrderContainer {
-        std::multimap<double, Order, std::greater<double>> buyOrders; // buyOrders desc
-        std::multimap<double, Order> sellOrders;                      // sellOrders asc
+        BuyOrders buyOrders;   // buyOrders desc
+        SellOrders sellOrders; // sellOrders asc
+    };
+    // locates an order in its book and in the expiry wheel without scanning
+    struct OrderRecord {
+        OrderContainer* container;
+        bool isBuy;
+        BuyOrders::iterator buyIt;
+        SellOrders::iterator sellIt;
+        bool hasExpiry;
+        TimingWheel::Handle expiryHandle;
     };
+    using OrderRecordMap = std::unordered_map<std::string, OrderRecord>;
+
+    // caller must hold the unique lock
+    void removeOrder(OrderRecordMap::iterator recordIt);
+
     // read-write lock
     mutable std::shared_mutex mutex_;
     std::unordered_map<std::string, OrderContainer> symbolOrderBooks_;
-    std::unordered_map<std::string, Order> orderById_;
+    OrderRecordMap orderById_;
+    std::unordered_set<std::string> dayOrderIds_;
+    TimingWheel expiryWheel_;
 };
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <string>
+#include <vector>
+
+// Hierarchical timing wheel keyed by order id. Every level has SLOT_COUNT slots; a slot on level L spans
+// SLOT_COUNT^L ticks and is cascaded into the level below when the wheel reaches it. Timers further out than
+// the whole wheel wait in an overflow list that is re-placed every time the top level wraps.
+class TimingWheel {
+  public:
+    struct Entry {
+        std::string orderId;
+        int64_t expireTick;
+        std::list<Entry>* bucket; // list currently holding this entry
+    };
+    // list iterators stay valid across splice, so a handle survives cascading between levels
+    using Handle = std::list<Entry>::iterator;
+
+    TimingWheel(int64_t startTimeMs, int64_t tickMs = 1);
+
+    // entries point into the wheel's own lists
+    TimingWheel(const TimingWheel&) = delete;
+    TimingWheel& operator=(const TimingWheel&) = delete;
+    TimingWheel(TimingWheel&&) = delete;
+    TimingWheel& operator=(TimingWheel&&) = delete;
+
+    // O(1), expireTimeMs at or before the current time fires on the next advance()
+    Handle schedule(const std::string& orderId, int64_t expireTimeMs);
+
+    // O(1)
+    void cancel(Handle handle);
+
+    // moves the wheel to nowMs and appends the ids of every expired timer to expiredOrderIds
+    void advance(int64_t nowMs, std::vector<std::string>& expiredOrderIds);
+
+    size_t size() const { return size_; }
+
+  private:
+    static constexpr size_t SLOT_BITS = 8;
+    static constexpr size_t SLOT_COUNT = 1 << SLOT_BITS;
+    static constexpr size_t SLOT_MASK = SLOT_COUNT - 1;
+    static constexpr size_t LEVEL_COUNT = 4;
+
+    int64_t toTick(int64_t timeMs) const;
+
+    std::list<Entry>& bucketFor(int64_t expireTick);
+
+    int64_t nextEventTick() const;
+
+    bool levelEmpty(size_t level) const;
+
+    void place(Handle handle, std::list<Entry>& from);
+
+    void cascade(size_t level);
+
+    void drain(std::list<Entry>& bucket, std::vector<std::string>& expiredOrderIds);
+
+    const int64_t startTimeMs_;
+    const int64_t tickMs_;
+    int64_t currentTick_{0};
+    size_t size_{0};
+    std::vector<std::list<Entry>> slots_; // LEVEL_COUNT * SLOT_COUNT, never resized
+    std::list<Entry> overflow_;
+    std::list<Entry> due_;
+};
@@ -1,7 +1,19 @@
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <iterator>
 #include <mutex>
+#include <stdexcept>
 
 #include "orderbook.hpp"
 
+OrderBook::OrderBook()
+    : OrderBook(std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::system_clock::now().time_since_epoch())
+                    .count()) {}
+
+OrderBook::OrderBook(int64_t startTimeMs, int64_t expiryTickMs) : expiryWheel_(startTimeMs, expiryTickMs) {}
+
 void OrderBook::matchOrders(const std::string& symbol) {
     std::unique_lock<std::shared_mutex> lock(mutex_);
 
@@ -9,21 +21,19 @@ void OrderBook::matchOrders(const std::string& symbol) {
 
     // order matches
     while (!orderContainer.buyOrders.empty() && !orderContainer.sellOrders.empty()) {
-        auto bestBuyIt = orderContainer.buyOrders.begin();
-        auto bestSellIt = orderContainer.sellOrders.begin();
-
-        if (bestBuyIt->first >= bestSellIt->first) {
-            if (bestBuyIt->second.qty > bestSellIt->second.qty) {
-                orderContainer.sellOrders.erase(bestSellIt);
-                bestBuyIt->second.qty -= bestSellIt->second.qty;
-            } else if (bestBuyIt->second.qty < bestSellIt->second.qty) {
-                orderContainer.buyOrders.erase(bestBuyIt);
-                bestSellIt->second.qty -= bestBuyIt->second.qty;
-            } else {
-                orderContainer.buyOrders.erase(bestBuyIt);
-                orderContainer.sellOrders.erase(bestSellIt);
-            }
-
+        Order& bestBuy = orderContainer.buyOrders.begin()->second;
+        Order& bestSell = orderContainer.sellOrders.begin()->second;
+
+        if (bestBuy.price >= bestSell.price) {
+            double fillQty = std::min(bestBuy.qty, bestSell.qty);
+            bestBuy.qty -= fillQty;
+            bestSell.qty -= fillQty;
+
+            // filled orders also leave the id index and the expiry wheel
+            std::string buyId = bestBuy.id;
+            std::string sellId = bestSell.id;
+            if (bestBuy.qty <= 0) { removeOrder(orderById_.find(buyId)); }
+            if (bestSell.qty <= 0) { removeOrder(orderById_.find(sellId)); }
         } else {
             break;
         }
@@ -31,15 +41,30 @@ void OrderBook::matchOrders(const std::string& symbol) {
 }
 
 void OrderBook::addOrder(const Order& order) {
+    if (order.timeInForce == TimeInForce::GTD && order.expireTime == 0) {
+        throw std::invalid_argument("GTD order must have an expire time");
+    }
+
     std::unique_lock<std::shared_mutex> lock(mutex_);
 
+    auto existingIt = orderById_.find(order.id);
+    if (existingIt != orderById_.end()) { removeOrder(existingIt); }
+
     auto& orderContainer = symbolOrderBooks_[order.symbol];
+    OrderRecord record{};
+    record.container = &orderContainer;
+    record.isBuy = order.isBuy;
     if (order.isBuy) {
-        orderContainer.buyOrders.insert({order.price, order});
+        record.buyIt = orderContainer.buyOrders.insert({order.price, order});
     } else {
-        orderContainer.sellOrders.insert({order.price, order});
+        record.sellIt = orderContainer.sellOrders.insert({order.price, order});
     }
-    orderById_[order.id] = order;
+    if (order.timeInForce != TimeInForce::GTC && order.expireTime != 0) {
+        record.hasExpiry = true;
+        record.expiryHandle = expiryWheel_.schedule(order.id, order.expireTime);
+    }
+    if (order.timeInForce == TimeInForce::DAY) { dayOrderIds_.insert(order.id); }
+    orderById_.emplace(order.id, record);
 }
 
 bool OrderBook::cancelOrder(const std::string& orderId) {
@@ -48,28 +73,7 @@ bool OrderBook::cancelOrder(const std::string& orderId) {
     auto orderIt = orderById_.find(orderId);
     if (orderIt == orderById_.end()) { return false; }
 
-    Order& order = orderIt->second;
-    auto& orderContainer = symbolOrderBooks_[order.symbol];
-
-    if (order.isBuy) {
-        auto range = orderContainer.buyOrders.equal_range(order.price);
-        for (auto it = range.first; it != range.second; ++it) {
-            if (it->second.id == orderId) {
-                orderContainer.buyOrders.erase(it);
-                break;
-            }
-        }
-    } else {
-        auto range = orderContainer.sellOrders.equal_range(order.price);
-        for (auto it = range.first; it != range.second; ++it) {
-            if (it->second.id == orderId) {
-                orderContainer.sellOrders.erase(it);
-                break;
-            }
-        }
-    }
-
-    orderById_.erase(orderId);
+    removeOrder(orderIt);
     return true;
 }
 
@@ -79,15 +83,75 @@ bool OrderBook::modifyOrderQuantity(const std::string& orderId, size_t newQuanti
     auto orderIt = orderById_.find(orderId);
     if (orderIt == orderById_.end()) { return false; }
 
-    Order& order = orderIt->second;
-    order.qty = newQuantity;
-
     // if quantity is 0, cancel order
-    if (newQuantity == 0) { return cancelOrder(orderId); }
+    if (newQuantity == 0) {
+        removeOrder(orderIt);
+        return true;
+    }
+
+    OrderRecord& record = orderIt->second;
+    Order& order = record.isBuy ? record.buyIt->second : record.sellIt->second;
+    order.qty = newQuantity;
 
     return true;
 }
 
+size_t OrderBook::expireOrders(int64_t nowMs, std::vector<std::string>* expiredOrderIds) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+
+    std::vector<std::string> expired;
+    expiryWheel_.advance(nowMs, expired);
+
+    for (const auto& orderId : expired) {
+        auto orderIt = orderById_.find(orderId);
+        // removeOrder cancels the timer of every order it removes, so each expired id is still resting
+        assert(orderIt != orderById_.end());
+        // the wheel already dropped the timer
+        orderIt->second.hasExpiry = false;
+        removeOrder(orderIt);
+    }
+
+    size_t expiredCount = expired.size();
+    if (expiredOrderIds) {
+        expiredOrderIds->insert(expiredOrderIds->end(), std::make_move_iterator(expired.begin()),
+                                std::make_move_iterator(expired.end()));
+    }
+    return expiredCount;
+}
+
+size_t OrderBook::cancelDayOrders(std::vector<std::string>* cancelledOrderIds) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+
+    // take the whole index so removeOrder does not erase from the set being walked
+    std::unordered_set<std::string> dayOrderIds;
+    dayOrderIds.swap(dayOrderIds_);
+
+    for (const auto& orderId : dayOrderIds) {
+        auto orderIt = orderById_.find(orderId);
+        if (orderIt != orderById_.end()) { removeOrder(orderIt); }
+    }
+
+    if (cancelledOrderIds) {
+        cancelledOrderIds->insert(cancelledOrderIds->end(), dayOrderIds.begin(), dayOrderIds.end());
+    }
+    return dayOrderIds.size();
+}
+
+void OrderBook::removeOrder(OrderRecordMap::iterator recordIt) {
+    OrderRecord& record = recordIt->second;
+    const Order& order = record.isBuy ? record.buyIt->second : record.sellIt->second;
+
+    if (order.timeInForce == TimeInForce::DAY) { dayOrderIds_.erase(order.id); }
+    if (record.hasExpiry) { expiryWheel_.cancel(record.expiryHandle); }
+
+    if (record.isBuy) {
+        record.container->buyOrders.erase(record.buyIt);
+    } else {
+        record.container->sellOrders.erase(record.sellIt);
+    }
+    orderById_.erase(recordIt);
+}
+
 std::vector<Order> OrderBook::getOrdersForSymbol(const std::string& symbol, bool isBuy) const {
     std::shared_lock<std::shared_mutex> lock(mutex_);
 
@@ -0,0 +1,116 @@
+#include <iterator>
+#include <stdexcept>
+
+#include "timing_wheel.hpp"
+
+TimingWheel::TimingWheel(int64_t startTimeMs, int64_t tickMs)
+    : startTimeMs_(startTimeMs), tickMs_(tickMs), slots_(LEVEL_COUNT * SLOT_COUNT) {
+    if (tickMs <= 0) { throw std::invalid_argument("Tick must be greater than 0 milliseconds"); }
+}
+
+TimingWheel::Handle TimingWheel::schedule(const std::string& orderId, int64_t expireTimeMs) {
+    // round up so a timer never fires before its expire time
+    int64_t elapsedMs = expireTimeMs - startTimeMs_;
+    int64_t expireTick = elapsedMs > 0 ? elapsedMs / tickMs_ + (elapsedMs % tickMs_ != 0) : 0;
+
+    due_.push_back(Entry{orderId, expireTick, &due_});
+    Handle handle = std::prev(due_.end());
+    place(handle, due_);
+    ++size_;
+    return handle;
+}
+
+void TimingWheel::cancel(Handle handle) {
+    handle->bucket->erase(handle);
+    --size_;
+}
+
+void TimingWheel::advance(int64_t nowMs, std::vector<std::string>& expiredOrderIds) {
+    int64_t targetTick = toTick(nowMs);
+    drain(due_, expiredOrderIds);
+
+    while (currentTick_ < targetTick) {
+        // skip ticks that neither expire nor cascade anything
+        int64_t nextTick = size_ == 0 ? targetTick + 1 : nextEventTick();
+        if (nextTick > targetTick) {
+            currentTick_ = targetTick;
+            break;
+        }
+        currentTick_ = nextTick;
+
+        // find the highest level whose slot boundary was just crossed
+        size_t topLevel = 0;
+        while (topLevel + 1 < LEVEL_COUNT &&
+               (currentTick_ & ((int64_t{1} << (SLOT_BITS * (topLevel + 1))) - 1)) == 0) {
+            ++topLevel;
+        }
+        if (topLevel + 1 == LEVEL_COUNT && (currentTick_ & ((int64_t{1} << (SLOT_BITS * LEVEL_COUNT)) - 1)) == 0) {
+            std::list<Entry> pending;
+            pending.splice(pending.end(), overflow_);
+            while (!pending.empty()) { place(pending.begin(), pending); }
+        }
+        // higher levels first, their entries may land in a lower level slot that is cascaded on this tick too
+        for (size_t level = topLevel; level > 0; --level) { cascade(level); }
+
+        drain(slots_[currentTick_ & SLOT_MASK], expiredOrderIds);
+        drain(due_, expiredOrderIds);
+    }
+}
+
+int64_t TimingWheel::toTick(int64_t timeMs) const {
+    int64_t elapsedMs = timeMs - startTimeMs_;
+    return elapsedMs > 0 ? elapsedMs / tickMs_ : 0;
+}
+
+std::list<TimingWheel::Entry>& TimingWheel::bucketFor(int64_t expireTick) {
+    if (expireTick <= currentTick_) { return due_; }
+
+    // lowest level on which the expire tick and the current tick share every higher slot index
+    for (size_t level = 0; level < LEVEL_COUNT; ++level) {
+        size_t shift = SLOT_BITS * (level + 1);
+        if ((expireTick >> shift) == (currentTick_ >> shift)) {
+            size_t slot = (expireTick >> (SLOT_BITS * level)) & SLOT_MASK;
+            return slots_[level * SLOT_COUNT + slot];
+        }
+    }
+    return overflow_;
+}
+
+void TimingWheel::place(Handle handle, std::list<Entry>& from) {
+    std::list<Entry>& to = bucketFor(handle->expireTick);
+    to.splice(to.end(), from, handle);
+    handle->bucket = &to;
+}
+
+int64_t TimingWheel::nextEventTick() const {
+    // next occupied slot in the current level 0 rotation
+    for (int64_t tick = currentTick_ + 1; (tick & SLOT_MASK) != 0; ++tick) {
+        if (!slots_[tick & SLOT_MASK].empty()) { return tick; }
+    }
+
+    // otherwise the next slot boundary of the lowest occupied level, the overflow list wraps with the top level
+    size_t level = 1;
+    while (level < LEVEL_COUNT && levelEmpty(level)) { ++level; }
+    int64_t span = int64_t{1} << (SLOT_BITS * level);
+    return (currentTick_ / span + 1) * span;
+}
+
+bool TimingWheel::levelEmpty(size_t level) const {
+    for (size_t slot = 0; slot < SLOT_COUNT; ++slot) {
+        if (!slots_[level * SLOT_COUNT + slot].empty()) { return false; }
+    }
+    return true;
+}
+
+void TimingWheel::cascade(size_t level) {
+    size_t slot = (currentTick_ >> (SLOT_BITS * level)) & SLOT_MASK;
+    std::list<Entry> pending;
+    pending.splice(pending.end(), slots_[level * SLOT_COUNT + slot]);
+    while (!pending.empty()) { place(pending.begin(), pending); }
+}
+
+void TimingWheel::drain(std::list<Entry>& bucket, std::vector<std::string>& expiredOrderIds) {
+    for (const auto& entry : bucket) { expiredOrderIds.push_back(entry.orderId); }
+    size_ -= bucket.size();
+    bucket.clear();
+}
@@ -1,6 +1,8 @@
 #include <atomic>
 #include <cassert>
+#include <cstdint>
 #include <iostream>
+#include <stdexcept>
 #include <thread>
 
 #include "orderbook.hpp"
@@ -24,6 +26,10 @@ class OrderBookTest {
         testRateLimitForConcurrentOrderPlacement(RiskControl::RateLimiterType::TokenBucket, 1, 100);
         // high concurrency
         testRateLimitForConcurrentOrderPlacement(RiskControl::RateLimiterType::TokenBucket, 100, 20);
+        testOrderExpiry();
+        testDayOrderSessionEnd();
+        testGtdOrderWithoutExpireTime();
+        testReplaceOrderWithSameId();
         std::cout << "All tests passed." << std::endl;
         std::cout << "You can go and have a good sleep:)" << std::endl;
     }
@@ -221,6 +227,113 @@ class OrderBookTest {
 
         std::cout << "Concurrent order placement test passed.\n";
     }
+
+    // Test GTD/DAY expiry through the timing wheel
+    static void testOrderExpiry() {
+        OrderBook orderBook(0);
+
+        orderBook.addOrder(Order("1", "AAPL", 150.0, 100, true, TimeInForce::GTD, 10));
+        orderBook.addOrder(Order("2", "AAPL", 149.0, 100, true, TimeInForce::GTD, 300));        // cascades once
+        orderBook.addOrder(Order("3", "AAPL", 151.0, 100, false, TimeInForce::DAY, 70000));     // cascades twice
+        orderBook.addOrder(Order("4", "AAPL", 152.0, 100, false, TimeInForce::GTD, 5000000000)); // overflow
+        orderBook.addOrder(Order("5", "AAPL", 148.0, 100, true, TimeInForce::GTC, 10));          // never expires
+        orderBook.addOrder(Order("6", "AAPL", 147.0, 100, true, TimeInForce::GTD, 20));
+
+        std::vector<std::string> expired;
+        assert(orderBook.expireOrders(9, &expired) == 0);
+        assert(orderBook.expireOrders(10, &expired) == 1);
+        assert(expired.size() == 1 && expired[0] == "1");
+
+        // cancelled orders are gone from the wheel too
+        assert(orderBook.cancelOrder("6"));
+        assert(orderBook.expireOrders(299) == 0);
+        assert(orderBook.expireOrders(300) == 1);
+        assert(orderBook.getBestPrices("AAPL").first == 148.0);
+
+        assert(orderBook.expireOrders(69999) == 0);
+        assert(orderBook.expireOrders(70000) == 1);
+        assert(orderBook.getBestPrices("AAPL").second == 152.0);
+
+        assert(orderBook.expireOrders(4999999999) == 0);
+        assert(orderBook.expireOrders(5000000000) == 1);
+        assert(orderBook.getOrdersForSymbol("AAPL", false).empty());
+        assert(orderBook.getOrdersForSymbol("AAPL", true).size() == 1);
+
+        // already expired on arrival, filled orders drop their timers
+        orderBook.addOrder(Order("7", "AAPL", 146.0, 100, true, TimeInForce::GTD, 100));
+        orderBook.addOrder(Order("8", "AAPL", 148.0, 100, false, TimeInForce::GTD, 6000000000));
+        orderBook.matchOrders("AAPL");
+        assert(orderBook.getOrdersForSymbol("AAPL", false).empty());
+        assert(orderBook.expireOrders(5000000001) == 1);
+        assert(orderBook.expireOrders(6000000000) == 0);
+        assert(orderBook.getOrdersForSymbol("AAPL", true).empty());
+
+        std::cout << "Order expiry test passed." << std::endl;
+    }
+
+    // Test bulk cancellation of DAY orders at session end
+    static void testDayOrderSessionEnd() {
+        OrderBook orderBook(0);
+
+        for (int i = 0; i < 1000; ++i) {
+            orderBook.addOrder(Order(std::to_string(i), "AAPL", 100.0 + (i % 10), 10, true, TimeInForce::DAY));
+        }
+        orderBook.addOrder(Order("gtc", "AAPL", 90.0, 10, true));
+        orderBook.addOrder(Order("day", "MSFT", 90.0, 10, false, TimeInForce::DAY, 1000));
+        assert(orderBook.cancelOrder("0"));
+        assert(orderBook.modifyOrderQuantity("1", 0));
+
+        std::vector<std::string> cancelled;
+        assert(orderBook.cancelDayOrders(&cancelled) == 999);
+        assert(cancelled.size() == 999);
+        assert(orderBook.getOrdersForSymbol("AAPL", true).size() == 1);
+        assert(orderBook.getOrdersForSymbol("MSFT", false).empty());
+        assert(orderBook.cancelDayOrders() == 0);
+        assert(orderBook.expireOrders(1000) == 0);
+        assert(orderBook.cancelOrder("gtc"));
+
+        std::cout << "DAY order session end test passed." << std::endl;
+    }
+
+    // Test GTD orders must carry an expire time
+    static void testGtdOrderWithoutExpireTime() {
+        OrderBook orderBook(0);
+
+        bool rejected = false;
+        try {
+            orderBook.addOrder(Order("1", "AAPL", 150.0, 100, true, TimeInForce::GTD));
+        } catch (const std::invalid_argument&) { rejected = true; }
+        assert(rejected);
+        assert(orderBook.getOrdersForSymbol("AAPL", true).empty());
+
+        // far future expiry does not overflow the tick computation
+        orderBook.addOrder(Order("2", "AAPL", 150.0, 100, true, TimeInForce::GTD, INT64_MAX));
+        assert(orderBook.expireOrders(6000000000) == 0);
+        assert(orderBook.getOrdersForSymbol("AAPL", true).size() == 1);
+
+        std::cout << "GTD order without expire time test passed." << std::endl;
+    }
+
+    // Test an order with an existing id replaces the resting one
+    static void testReplaceOrderWithSameId() {
+        OrderBook orderBook(0);
+
+        orderBook.addOrder(Order("1", "AAPL", 150.0, 100, true, TimeInForce::GTD, 10));
+        orderBook.addOrder(Order("2", "AAPL", 149.0, 100, true));
+        orderBook.addOrder(Order("1", "AAPL", 149.0, 50, true));
+
+        std::vector<Order> orders = orderBook.getOrdersForSymbol("AAPL", true);
+        assert(orders.size() == 2);
+        // the replacement queues behind order 2 at the same price
+        assert(orders[0].id == "2");
+        assert(orders[1].id == "1" && orders[1].qty == 50);
+
+        // the replaced order's timer went with it
+        assert(orderBook.expireOrders(10) == 0);
+        assert(orderBook.getOrdersForSymbol("AAPL", true).size() == 2);
+
+        std::cout << "Replace order with same id test passed." << std::endl;
+    }
 };
 
 int main() {